@@ -0,0 +1,74 @@
+#include "ledger.hpp"
+
+#include <QDate>
+#include <QThread>
+#include <chrono>
+#include <cstdio>
+#include <future>
+
+/*
+Build a csv file of the given size starting on 2020-01-01
+    - every day holds minPerDay to maxPerDay records, spread evenly over the day
+    - every record lasts two thirds of its slot, so it never crosses midnight
+*/
+QByteArray makeLedger(qint64 size, int minPerDay, int maxPerDay) {
+    QByteArray data("Start Time,End Time,Total Time,Description\n");
+    char line[128];
+    for (QDate date(2020, 1, 1); data.size() < size; date = date.addDays(1)) {
+        QByteArray day = date.toString("yyyy-MM-dd").toUtf8();
+        int records = minPerDay + static_cast<int>(date.toJulianDay() % (maxPerDay - minPerDay + 1));
+        int slot = 24 * 60 / records; // in minutes
+        for (int i = 0; i < records; ++i) {
+            int start = i * slot, end = start + slot * 2 / 3;
+            std::snprintf(line, sizeof(line), "%s %02d:%02d:00,%s %02d:%02d:00,%02d:%02d,Task %d\n",
+                          day.constData(), start / 60, start % 60, day.constData(), end / 60, end % 60,
+                          (end - start) / 60, (end - start) % 60, i);
+            data += line;
+        }
+    }
+    return data;
+}
+
+// Best of a few runs, in milliseconds
+double timeParse(QByteArray const &data, int threads) {
+    double best = 0;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        LedgerSummary summary = parseLedger(data, threads);
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (summary.records == 0)
+            std::printf("unexpected empty ledger\n");
+        best = run == 0 ? ms : qMin(best, ms);
+    }
+    return best;
+}
+
+// Scaling: a large input at increasing thread counts
+void benchmarkScaling(char const *name, QByteArray const &data) {
+    std::printf("\n%s: %lld MiB, %d records\n", name, static_cast<long long>(data.size() >> 20),
+                static_cast<int>(data.count('\n') - 1));
+    std::printf("%-8s %10s %8s\n", "threads", "ms", "speedup");
+    double sequential = timeParse(data, 1);
+    for (int threads : {1, 2, 4, 8}) {
+        double ms = threads == 1 ? sequential : timeParse(data, threads);
+        std::printf("%-8d %10.2f %8.2f\n", threads, ms, sequential / ms);
+    }
+}
+
+int main() {
+    std::printf("ideal thread count: %d\n", QThread::idealThreadCount());
+    benchmarkScaling("3-10 records per day", makeLedger(qint64(64) << 20, 3, 10));
+    benchmarkScaling("40-50 records per day", makeLedger(qint64(64) << 20, 40, 50));
+
+    // Threshold: the cost of parsing one chunk of kLedgerMinChunkSize against starting a thread for it
+    double chunk = timeParse(makeLedger(kLedgerMinChunkSize, 3, 10), 1);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i)
+        std::async(std::launch::async, [] { return 0; }).get();
+    auto end = std::chrono::steady_clock::now();
+    double spawn = std::chrono::duration<double, std::micro>(end - start).count() / 1000;
+    std::printf("\nparse %lld KiB: %.3f ms, thread start + join: %.1f us (%.1f%%)\n",
+                static_cast<long long>(kLedgerMinChunkSize >> 10), chunk, spawn, spawn / (chunk * 10));
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "ledger.hpp"
+
+#include <QDateTime>
+#include <QThread>
+#include <QTimeZone>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace {
+
+QString const kFormat = "yyyy-MM-dd hh:mm:ss";
+
+// Return the index-th comma separated field of the line [begin, end), or an empty string if missing
+QString field(char const *begin, char const *end, int index) {
+    for (; index > 0; --index) {
+        char const *comma = static_cast<char const *>(std::memchr(begin, ',', end - begin));
+        if (comma == nullptr)
+            return QString();
+        begin = comma + 1;
+    }
+    char const *comma = static_cast<char const *>(std::memchr(begin, ',', end - begin));
+    return QString::fromUtf8(begin, static_cast<int>((comma ? comma : end) - begin));
+}
+
+// Parse n ascii digits
+bool digits(char const *begin, int n, int &value) {
+    value = 0;
+    for (int i = 0; i < n; ++i) {
+        unsigned digit = static_cast<unsigned char>(begin[i]) - '0';
+        if (digit > 9)
+            return false;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    return true;
+}
+
+// A wall clock time split into julian day and seconds since midnight, no time zone involved
+struct WallTime {
+    qint64 day = 0;
+    int seconds = 0;
+};
+
+// Parse a field of exactly "yyyy-MM-dd hh:mm:ss", anything else is left to QDateTime::fromString
+bool parseWallTime(char const *begin, char const *end, WallTime &time) {
+    if (end - begin != 19 || begin[4] != '-' || begin[7] != '-' || begin[10] != ' ' || begin[13] != ':' ||
+        begin[16] != ':')
+        return false;
+    int year, month, day, hour, minute, second;
+    if (!digits(begin, 4, year) || !digits(begin + 5, 2, month) || !digits(begin + 8, 2, day) ||
+        !digits(begin + 11, 2, hour) || !digits(begin + 14, 2, minute) || !digits(begin + 17, 2, second))
+        return false;
+    if (!QDate::isValid(year, month, day) || !QTime::isValid(hour, minute, second))
+        return false;
+    time.day = QDate(year, month, day).toJulianDay();
+    time.seconds = hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+// Parse Start Time and End Time of the line [begin, end) when both are exactly "yyyy-MM-dd hh:mm:ss"
+bool parseWallTimes(char const *begin, char const *end, WallTime &startTime, WallTime &endTime) {
+    char const *first = static_cast<char const *>(std::memchr(begin, ',', end - begin));
+    if (first == nullptr)
+        return false;
+    char const *second = static_cast<char const *>(std::memchr(first + 1, ',', end - first - 1));
+    return parseWallTime(begin, first, startTime) &&
+           parseWallTime(first + 1, second != nullptr ? second : end, endTime);
+}
+
+/*
+Days on which the local time offset may change (DST), computed once before the chunks start so that parsing
+never touches the time zone. Days outside [first, last] are unknown and treated as unstable.
+*/
+class UnstableDays {
+  public:
+    UnstableDays() = default;
+    UnstableDays(qint64 first, qint64 last);
+
+    bool stable(qint64 day) const {
+        return day >= mFirst && day <= mLast && !std::binary_search(mDays.begin(), mDays.end(), day);
+    }
+
+  private:
+    qint64 mFirst = 1, mLast = 0;
+    std::vector<qint64> mDays;
+};
+
+UnstableDays::UnstableDays(qint64 first, qint64 last) {
+    QTimeZone zone = QTimeZone::systemTimeZone();
+    QDateTime from(QDate::fromJulianDay(first - 2), QTime(0, 0), Qt::UTC);
+    QDateTime to(QDate::fromJulianDay(last + 3), QTime(0, 0), Qt::UTC);
+
+    // The zone must agree with the local time used by QDateTime::fromString, otherwise nothing is stable
+    for (QDateTime const &utc : {from, to})
+        if (zone.offsetFromUtc(utc) != utc.toLocalTime().offsetFromUtc())
+            return;
+    if (zone.hasTransitions()) {
+        for (QTimeZone::OffsetData const &transition : zone.transitions(from, to)) {
+            // Local day after the change, the local day before it differs by at most one (e.g. Samoa 2011)
+            qint64 day = transition.atUtc.addSecs(transition.offsetFromUtc).date().toJulianDay();
+            for (qint64 neighbour = day - 2; neighbour <= day + 2; ++neighbour)
+                mDays.push_back(neighbour);
+        }
+        std::sort(mDays.begin(), mDays.end());
+        mDays.erase(std::unique(mDays.begin(), mDays.end()), mDays.end());
+    } else if (zone.hasDaylightTime()) {
+        return;
+    }
+    mFirst = first;
+    mLast = last;
+}
+
+// Unstable days over the range covered by the first and the last parsable record in [begin, end), records
+// outside of it (unsorted files) still parse correctly through the QDateTime fallback
+UnstableDays unstableDays(char const *begin, char const *end) {
+    WallTime startTime, endTime;
+    qint64 first = 0, last = 0;
+    bool found = false;
+    for (char const *line = begin; line < end && !found;) {
+        char const *newline = static_cast<char const *>(std::memchr(line, '\n', end - line));
+        if (parseWallTimes(line, newline, startTime, endTime)) {
+            first = qMin(startTime.day, endTime.day);
+            last = qMax(startTime.day, endTime.day);
+            found = true;
+        }
+        line = newline + 1;
+    }
+    if (!found)
+        return UnstableDays();
+    for (char const *newline = end - 1;;) {
+        char const *line = newline;
+        while (line > begin && line[-1] != '\n')
+            --line;
+        if (parseWallTimes(line, newline, startTime, endTime)) {
+            first = qMin(first, qMin(startTime.day, endTime.day));
+            last = qMax(last, qMax(startTime.day, endTime.day));
+            break;
+        }
+        if (line == begin)
+            break;
+        newline = line - 1;
+    }
+    return UnstableDays(first, last);
+}
+
+// Same as QDateTime::fromString(Start Time).secsTo(QDateTime::fromString(End Time)) for the line [begin, end)
+qint64 recordSeconds(char const *begin, char const *end, UnstableDays const &days) {
+    // Fast path: both ends on the same or consecutive days without any offset change in between
+    WallTime startTime, endTime;
+    if (parseWallTimes(begin, end, startTime, endTime)) {
+        qint64 elapsed = endTime.day - startTime.day;
+        if ((elapsed == 0 || elapsed == 1) && days.stable(startTime.day) && days.stable(endTime.day))
+            return elapsed * 86400 + endTime.seconds - startTime.seconds;
+    }
+
+    QDateTime startDateTime = QDateTime::fromString(field(begin, end, 0), kFormat);
+    QDateTime endDateTime = QDateTime::fromString(field(begin, end, 1), kFormat);
+    return startDateTime.secsTo(endDateTime);
+}
+
+// Parse all '\n' terminated lines in [begin, end), end must be right after a '\n'
+LedgerSummary parseChunk(char const *begin, char const *end, UnstableDays const &days) {
+    LedgerSummary summary;
+    while (begin < end) {
+        char const *newline = static_cast<char const *>(std::memchr(begin, '\n', end - begin));
+        summary.totalSeconds += recordSeconds(begin, newline, days);
+        summary.records += 1;
+        begin = newline + 1;
+    }
+    return summary;
+}
+
+} // namespace
+
+LedgerSummary parseLedger(QByteArray const &data, int threads) {
+    char const *first = data.constData();
+    char const *last = first + data.size();
+
+    // Skip the header
+    char const *header = static_cast<char const *>(std::memchr(first, '\n', last - first));
+    if (header == nullptr)
+        return LedgerSummary();
+    first = header + 1;
+
+    // Drop the trailing partial line, if any
+    while (last > first && last[-1] != '\n')
+        --last;
+
+    if (threads <= 0)
+        threads = QThread::idealThreadCount();
+    qint64 size = last - first;
+    int chunks = static_cast<int>(qMin<qint64>(qMax(threads, 1), size / kLedgerMinChunkSize));
+    UnstableDays days = unstableDays(first, last);
+    if (chunks <= 1)
+        return parseChunk(first, last, days);
+
+    // Split into newline-aligned chunks
+    std::vector<char const *> bounds{first};
+    for (int i = 1; i < chunks; ++i) {
+        char const *bound = qMax(bounds.back(), first + size * i / chunks);
+        if (bound > first && bound[-1] != '\n')
+            bound = static_cast<char const *>(std::memchr(bound, '\n', last - bound)) + 1;
+        bounds.push_back(bound);
+    }
+    bounds.push_back(last);
+
+    std::vector<std::future<LedgerSummary>> futures;
+    for (int i = 0; i < chunks; ++i)
+        futures.push_back(
+            std::async(std::launch::async, parseChunk, bounds[i], bounds[i + 1], std::cref(days)));
+
+    // Merge in order
+    LedgerSummary summary;
+    for (std::future<LedgerSummary> &future : futures) {
+        LedgerSummary partial = future.get();
+        summary.records += partial.records;
+        summary.totalSeconds += partial.totalSeconds;
+    }
+    return summary;
+}
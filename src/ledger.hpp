@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QByteArray>
+
+// Minimum number of bytes per thread, smaller inputs are not worth the thread overhead
+constexpr qint64 kLedgerMinChunkSize = 1 << 20; // 1 MiB
+
+/*
+Aggregate of the records found in a csv file (Start Time,End Time,Total Time,Description)
+The records themselves are not kept, getPreviousWorkingTime only needs the total and keeping millions of
+parsed records would cost more memory than the file itself.
+*/
+struct LedgerSummary {
+    int records = 0;         // Number of records, excluding the header
+    qint64 totalSeconds = 0; // Sum of (End Time - Start Time) over all records
+};
+
+/*
+Parse the content of a csv file and sum up the working time of its records
+    - The first line is the header and is skipped
+    - Only lines terminated by '\n' are records, a trailing partial line is ignored
+    - threads <= 0 uses QThread::idealThreadCount(), small inputs are always parsed sequentially
+
+Large inputs are split into newline-aligned chunks which are parsed concurrently and merged in order,
+so the result is identical to the sequential parse.
+*/
+LedgerSummary parseLedger(QByteArray const &data, int threads = 0);
@@ -1,5 +1,6 @@
 #include "mainwindow.hpp"
 #include "description.hpp"
+#include "ledger.hpp"
 #include <QCloseEvent>
 #include <QDebug>
 #include <QFile>
@@ -85,8 +86,8 @@ void MainWindow::initialize() {
     this->getPreviousWorkingTime();
 
     // Update the mPreviousTotalWorkingTime
-    int hours = mPreviousTotalWorkingTime / 3600;
-    int minutes = (mPreviousTotalWorkingTime % 3600) / 60;
+    qint64 hours = mPreviousTotalWorkingTime / 3600;
+    qint64 minutes = (mPreviousTotalWorkingTime % 3600) / 60;
     mTotalWorkingTimeLabel.setText(
         QString("%1:%2").arg(hours, 2, 10, QChar('0')).arg(minutes, 2, 10, QChar('0')));
 }
@@ -141,9 +142,9 @@ void MainWindow::updateWorkingTime() {
     qDebug() << "Updating working time";
     // While working, update the current working time
     QDateTime current = QDateTime::currentDateTime();
-    int totalTime = mStartTime.secsTo(current);
-    int hours = totalTime / 3600;
-    int minutes = (totalTime % 3600) / 60;
+    qint64 totalTime = mStartTime.secsTo(current);
+    qint64 hours = totalTime / 3600;
+    qint64 minutes = (totalTime % 3600) / 60;
     QString currentTimeText = QString("%1:%2").arg(hours, 2, 10, QChar('0')).arg(minutes, 2, 10, QChar('0'));
     mCurrentWorkingTimeLabel.setText(currentTimeText);
 
@@ -247,24 +248,16 @@ void MainWindow::getPreviousWorkingTime() {
         return;
     }
 
-    QTextStream in(&file);
-    QStringList data = in.readAll().split("\n");
+    QByteArray data = file.readAll();
     file.close();
-    if (data.size() < 2) {
+    if (!data.contains('\n')) {
         mPreviousTotalWorkingTime = 0;
         return;
     }
-    int previousTotalWorkingTime = 0; // in seconds
-    qDebug() << data.size() - 2 << "records found";
-    for (int i = 1; i < data.size() - 1; ++i) {
-        QStringList row = data[i].split(",");
-        qDebug() << i << row;
-        QDateTime startTime = QDateTime::fromString(row[0], "yyyy-MM-dd hh:mm:ss");
-        QDateTime endTime = QDateTime::fromString(row[1], "yyyy-MM-dd hh:mm:ss");
-        int totalTime = startTime.secsTo(endTime);
-        previousTotalWorkingTime += totalTime;
-    }
-    mPreviousTotalWorkingTime = previousTotalWorkingTime;
+    // Large files are parsed in parallel, see parseLedger
+    LedgerSummary summary = parseLedger(data);
+    qDebug() << summary.records << "records found";
+    mPreviousTotalWorkingTime = summary.totalSeconds;
     initialized = true;
 }
 
@@ -27,7 +27,7 @@ class MainWindow : public QMainWindow {
     QSettings *mSettings;
     SettingsDialog *mSettingsDialog;
     QDateTime mStartTime = QDateTime::currentDateTime();
-    int mPreviousTotalWorkingTime = 0; // in seconds
+    qint64 mPreviousTotalWorkingTime = 0; // in seconds
     bool initialized = false;
 
     QLabel mCurrentWorkingTimeLabel;
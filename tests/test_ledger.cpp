@@ -0,0 +1,152 @@
+#include "ledger.hpp"
+
+#include <QDateTime>
+#include <gtest/gtest.h>
+
+class LedgerTest : public ::testing::Test {
+  protected:
+    static constexpr char const *kHeader = "Start Time,End Time,Total Time,Description\n";
+
+    /*
+    Append records until data reaches the given size, records of 1 to 60 minutes
+        - descriptionLength < 0: varying descriptions
+        - descriptionLength >= 0: every record has the same length
+    */
+    static void appendRecords(QByteArray &data, qint64 size, int descriptionLength = -1) {
+        QDateTime start = QDateTime::fromString("2024-01-01 08:00:00", "yyyy-MM-dd hh:mm:ss");
+        for (int count = 0; data.size() < size; ++count) {
+            QDateTime end = start.addSecs(60 * (count % 60 + 1));
+            QByteArray description = descriptionLength < 0 ? QByteArray(count % 17, 'x') + "\xc3\xa9"
+                                                           : QByteArray(descriptionLength, 'x');
+            data += start.toString("yyyy-MM-dd hh:mm:ss").toUtf8() + "," +
+                    end.toString("yyyy-MM-dd hh:mm:ss").toUtf8() + ",00:00," + description + "\n";
+            start = end.addSecs(30);
+        }
+    }
+
+    static void expectSameAsSequential(QByteArray const &data, std::initializer_list<int> threadCounts) {
+        LedgerSummary sequential = parseLedger(data, 1);
+        for (int threads : threadCounts) {
+            LedgerSummary parallel = parseLedger(data, threads);
+            EXPECT_EQ(parallel.records, sequential.records) << "threads: " << threads;
+            EXPECT_EQ(parallel.totalSeconds, sequential.totalSeconds) << "threads: " << threads;
+        }
+    }
+};
+
+TEST_F(LedgerTest, EmptyFile) {
+    LedgerSummary summary = parseLedger(QByteArray());
+    EXPECT_EQ(summary.records, 0);
+    EXPECT_EQ(summary.totalSeconds, 0);
+}
+
+TEST_F(LedgerTest, HeaderOnly) {
+    LedgerSummary summary = parseLedger("Start Time,End Time,Total Time,Description\n");
+    EXPECT_EQ(summary.records, 0);
+    EXPECT_EQ(summary.totalSeconds, 0);
+}
+
+TEST_F(LedgerTest, SingleRecord) {
+    LedgerSummary summary = parseLedger("Start Time,End Time,Total Time,Description\n"
+                                        "2024-01-01 08:00:00,2024-01-01 09:30:00,01:30,Work\n");
+    EXPECT_EQ(summary.records, 1);
+    EXPECT_EQ(summary.totalSeconds, 90 * 60);
+}
+
+TEST_F(LedgerTest, TrailingPartialLineIsIgnored) {
+    LedgerSummary summary = parseLedger("Start Time,End Time,Total Time,Description\n"
+                                        "2024-01-01 08:00:00,2024-01-01 08:10:00,00:10,Work\n"
+                                        "2024-01-01 09:00:00,2024-01-01 09:10:00,00:10,Work");
+    EXPECT_EQ(summary.records, 1);
+    EXPECT_EQ(summary.totalSeconds, 10 * 60);
+}
+
+TEST_F(LedgerTest, MalformedRecord) {
+    LedgerSummary summary = parseLedger("Start Time,End Time,Total Time,Description\n"
+                                        "garbage\n"
+                                        "2024-01-01 08:00:00,2024-01-01 08:10:00,00:10,Work\n");
+    EXPECT_EQ(summary.records, 2);
+    EXPECT_EQ(summary.totalSeconds, 10 * 60);
+}
+
+TEST_F(LedgerTest, ParallelMatchesSequential) {
+    QByteArray data(kHeader);
+    appendRecords(data, 5 * kLedgerMinChunkSize);
+
+    // Every record takes 1 to 60 minutes, cycling
+    int records = data.count('\n') - 1;
+    qint64 totalSeconds = 0;
+    for (int i = 0; i < records; ++i)
+        totalSeconds += 60 * (i % 60 + 1);
+    LedgerSummary sequential = parseLedger(data, 1);
+    EXPECT_EQ(sequential.records, records);
+    EXPECT_EQ(sequential.totalSeconds, totalSeconds);
+
+    expectSameAsSequential(data, {2, 3, 4, 8, 0});
+}
+
+TEST_F(LedgerTest, RecordLongerThanChunk) {
+    // A record spanning several chunks makes the following split points collapse into empty chunks
+    QByteArray data(kHeader);
+    appendRecords(data, kLedgerMinChunkSize);
+    data += "2024-01-02 08:00:00,2024-01-02 10:00:00,02:00," + QByteArray(5 * kLedgerMinChunkSize / 2, 'y') +
+            "\n";
+    appendRecords(data, data.size() + kLedgerMinChunkSize);
+    ASSERT_GT(data.size(), 4 * kLedgerMinChunkSize);
+
+    expectSameAsSequential(data, {2, 3, 4, 8});
+}
+
+TEST_F(LedgerTest, SplitOnLineBoundary) {
+    // Records of equal length, with a multiple of 4 records every split offset at 2 and 4 threads is right
+    // after a '\n'
+    QByteArray data(kHeader);
+    appendRecords(data, data.size() + 4 * kLedgerMinChunkSize, 20);
+    int header = static_cast<int>(qstrlen(kHeader));
+    int length = data.indexOf('\n', header) + 1 - header;
+    while ((data.size() - header) % (4 * length) != 0)
+        appendRecords(data, data.size() + 1, 20);
+    int size = data.size() - header;
+    ASSERT_EQ(data.at(header + size / 2 - 1), '\n');
+    ASSERT_EQ(data.at(header + size / 4 - 1), '\n');
+    ASSERT_EQ(data.at(header + 3 * size / 4 - 1), '\n');
+
+    expectSameAsSequential(data, {2, 4});
+}
+
+TEST_F(LedgerTest, DaylightSavingTime) {
+    // Records around a DST change must agree with QDateTime, 9h in Europe/Berlin against 10h of wall clock
+    QByteArray tz = qgetenv("TZ");
+    qputenv("TZ", "Europe/Berlin");
+    auto restore = [&tz]() {
+        if (tz.isNull())
+            qunsetenv("TZ");
+        else
+            qputenv("TZ", tz);
+    };
+    QDateTime winter = QDateTime::fromString("2024-01-15 12:00:00", "yyyy-MM-dd hh:mm:ss");
+    QDateTime summer = QDateTime::fromString("2024-07-15 12:00:00", "yyyy-MM-dd hh:mm:ss");
+    if (winter.offsetFromUtc() != 3600 || summer.offsetFromUtc() != 7200) {
+        restore();
+        GTEST_SKIP() << "TZ=Europe/Berlin is not supported here";
+    }
+
+    QByteArray data(kHeader);
+    data += "2024-03-30 23:30:00,2024-03-31 03:30:00,03:00,Spring\n"
+            "2024-03-31 01:30:00,2024-03-31 03:30:00,01:00,Spring\n"
+            "2024-10-27 01:30:00,2024-10-27 03:30:00,03:00,Autumn\n"
+            "2024-06-01 23:00:00,2024-06-02 01:00:00,02:00,Summer\n";
+    qint64 expected = 0;
+    for (QByteArray const &line : data.split('\n').mid(1, 4)) {
+        QList<QByteArray> row = line.split(',');
+        QDateTime start = QDateTime::fromString(QString::fromUtf8(row[0]), "yyyy-MM-dd hh:mm:ss");
+        QDateTime end = QDateTime::fromString(QString::fromUtf8(row[1]), "yyyy-MM-dd hh:mm:ss");
+        expected += start.secsTo(end);
+    }
+    LedgerSummary summary = parseLedger(data, 1);
+    restore();
+
+    EXPECT_EQ(summary.records, 4);
+    EXPECT_EQ(expected, (3 + 1 + 3 + 2) * 3600);
+    EXPECT_EQ(summary.totalSeconds, (3 + 1 + 3 + 2) * 3600);
+}